@@ -0,0 +1,232 @@
+// Side-by-side comparison of libpdbg and pdbg_targeting on the same DTB:
+// init latency and peak RSS (each init in a fresh child process, as in
+// tgttravel), full traversal and per-target attribute fetch. Every metric
+// is reported as p50/p95/p99 over the runs.
+//
+// Usage: tgtcompare [dtb] [runs]
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern "C" {
+#include "libpdbg.h"
+}
+
+#include "bench/bench_util.H"
+#include "target_service.H"
+
+namespace
+{
+constexpr auto DEFAULT_DEVTREE =
+    "/var/lib/phosphor-software-manager/pnor/rw/DEVTREE";
+
+// Same property for both models
+constexpr auto POS_ATTR = "ATTR_POS";
+
+struct InitSample
+{
+    double ms;
+    long hwmKb;
+};
+
+long hwmKb()
+{
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+    return 0;
+}
+
+void initPdbg(const char* devtree)
+{
+    if (setenv("PDBG_DTB", devtree, 1)) {
+        throw std::runtime_error(std::string("Failed to set PDBG_DTB: ") +
+                                 strerror(errno));
+    }
+    pdbg_set_backend(PDBG_BACKEND_SBEFIFO, NULL);
+    if (!pdbg_targets_init(NULL)) {
+        throw std::runtime_error("pdbg_targets_init failed");
+    }
+}
+
+void initTargeting(const char* devtree)
+{
+    TARGETING::TargetService::instance().init(devtree);
+}
+
+// Run init once per child so neither model benefits from a warm process
+std::vector<InitSample> timeInit(const std::function<void()>& init, int runs)
+{
+    std::vector<InitSample> samples;
+    for (int i = 0; i < runs; ++i) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw std::runtime_error("pipe failed");
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            InitSample sample{};
+            auto start = bench::Clock::now();
+            try {
+                init();
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                _exit(1);
+            }
+            sample.ms = bench::elapsedMs(start);
+            sample.hwmKb = hwmKb();
+            [[maybe_unused]] auto rc = write(fds[1], &sample, sizeof(sample));
+            _exit(0);
+        } else if (pid < 0) {
+            throw std::runtime_error("fork failed");
+        }
+        close(fds[1]);
+        InitSample sample{};
+        bool ok = read(fds[0], &sample, sizeof(sample)) == sizeof(sample);
+        close(fds[0]);
+        waitpid(pid, nullptr, 0);
+        if (!ok) {
+            throw std::runtime_error("init failed in child");
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+void countPdbg(struct pdbg_target* parent, size_t& count)
+{
+    struct pdbg_target* child;
+    ++count;
+    pdbg_for_each_child_target(parent, child) {
+        countPdbg(child, count);
+    }
+}
+
+void fetchPdbg(struct pdbg_target* parent, size_t& found)
+{
+    struct pdbg_target* child;
+    uint32_t value = 0;
+    if (pdbg_target_get_attribute(parent, POS_ATTR, 4, 1, &value)) {
+        ++found;
+    }
+    bench::doNotOptimize(value);
+    pdbg_for_each_child_target(parent, child) {
+        fetchPdbg(child, found);
+    }
+}
+
+// One sample per pass over every target
+std::vector<double> timePasses(int runs, size_t& ops,
+                               const std::function<size_t()>& pass)
+{
+    std::vector<double> samples;
+    for (int i = 0; i < runs; ++i) {
+        auto start = bench::Clock::now();
+        ops = pass();
+        samples.push_back(bench::elapsedMs(start));
+    }
+    return samples;
+}
+
+void row(const char* metric, const char* model, std::vector<double> samples,
+         const char* unit, double scale = 1.0)
+{
+    std::cout << std::left << std::setw(12) << metric << std::setw(11)
+              << model << std::right << std::fixed << std::setprecision(3);
+    for (double pct : {50.0, 95.0, 99.0}) {
+        std::cout << std::setw(12) << bench::percentile(samples, pct) * scale;
+    }
+    std::cout << "  " << unit << "\n";
+}
+
+void initRows(const char* model, const std::vector<InitSample>& samples)
+{
+    std::vector<double> ms, rss;
+    for (const auto& s : samples) {
+        ms.push_back(s.ms);
+        rss.push_back(static_cast<double>(s.hwmKb));
+    }
+    row("init", model, ms, "ms");
+    row("peak rss", model, rss, "KiB");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* devtree = argc > 1 ? argv[1] : DEFAULT_DEVTREE;
+    const int runs = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    try {
+        // Time both inits before this process loads either model
+        auto pdbgInit = timeInit([&] { initPdbg(devtree); }, runs);
+        auto tgtInit = timeInit([&] { initTargeting(devtree); }, runs);
+
+        initPdbg(devtree);
+        initTargeting(devtree);
+        auto& ts = TARGETING::TargetService::instance();
+
+        size_t pdbgNodes = 0, tgtNodes = 0, pdbgFound = 0, tgtFound = 0;
+        auto pdbgTraverse = timePasses(runs, pdbgNodes, [] {
+            size_t n = 0;
+            countPdbg(pdbg_target_root(), n);
+            return n;
+        });
+        auto tgtTraverse = timePasses(runs, tgtNodes, [&] {
+            size_t n = 0;
+            for (auto t = ts.getTopLevelTarget(); t; t = ts.getNextTarget(t)) {
+                ++n;
+            }
+            return n;
+        });
+        auto pdbgFetch = timePasses(runs, pdbgFound, [] {
+            size_t n = 0;
+            fetchPdbg(pdbg_target_root(), n);
+            return n;
+        });
+        auto tgtFetch = timePasses(runs, tgtFound, [&] {
+            size_t n = 0;
+            for (auto t = ts.getTopLevelTarget(); t; t = ts.getNextTarget(t)) {
+                uint32_t value = 0;
+                n += t->tryGetAttr<TARGETING::ATTR_POS>(value);
+                bench::doNotOptimize(value);
+            }
+            return n;
+        });
+
+        std::cout << "DTB " << devtree << ", " << runs << " runs\n"
+                  << "pdbg: " << pdbgNodes << " targets, " << pdbgFound
+                  << " with " << POS_ATTR << "\n"
+                  << "TARGETING: " << tgtNodes << " targets, " << tgtFound
+                  << " with " << POS_ATTR << "\n\n"
+                  << std::left << std::setw(12) << "metric" << std::setw(11)
+                  << "model" << std::right << std::setw(12) << "p50"
+                  << std::setw(12) << "p95" << std::setw(12) << "p99"
+                  << "\n";
+
+        initRows("pdbg", pdbgInit);
+        initRows("TARGETING", tgtInit);
+        row("traversal", "pdbg", pdbgTraverse, "ms");
+        row("traversal", "TARGETING", tgtTraverse, "ms");
+        // Per fetch: pass time spread over the targets visited
+        row("attr fetch", "pdbg", pdbgFetch, "ns/target",
+            pdbgNodes ? 1e6 / pdbgNodes : 0.0);
+        row("attr fetch", "TARGETING", tgtFetch, "ns/target",
+            tgtNodes ? 1e6 / tgtNodes : 0.0);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}